@@ -0,0 +1,200 @@
+/***************************************************************************
+ * Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+ * Martin Renou                                                             *
+ * Copyright (c) QuantStack                                                 *
+ * Copyright (c) Serge Guelton                                              *
+ *                                                                          *
+ * Distributed under the terms of the BSD 3-Clause License.                 *
+ *                                                                          *
+ * The full license is in the file LICENSE, distributed with this software. *
+ ****************************************************************************/
+
+#include "xsimd_algorithm/algorithms.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using duration_type = std::chrono::duration<double, std::milli>;
+
+template <class T>
+using aligned_vector = std::vector<T, xsimd::aligned_allocator<T>>;
+
+// Returns the best time out of ``repeat`` runs of f, setup being called
+// before each run and excluded from the measure.
+template <class S, class F>
+duration_type benchmark(S&& setup, F&& f, std::size_t repeat = 10)
+{
+    duration_type best = duration_type::max();
+    for (std::size_t i = 0; i < repeat; ++i)
+    {
+        setup();
+        auto start = std::chrono::steady_clock::now();
+        f();
+        auto end = std::chrono::steady_clock::now();
+        best = std::min(best, duration_type(end - start));
+    }
+    return best;
+}
+
+void print_result(std::string const& name, duration_type scalar, duration_type simd)
+{
+    std::cout << "  " << name << std::string(name.size() < 16 ? 16 - name.size() : 0, ' ')
+              << "scalar: " << scalar.count() << " ms\t"
+              << "xsimd: " << simd.count() << " ms\t"
+              << "speedup: " << scalar / simd << std::endl;
+}
+
+template <class T>
+struct input_set
+{
+    std::string name;
+    aligned_vector<T> values;
+};
+
+// Random keys are drawn from [min_key, max_key]; the sorted inputs are
+// derived from them, so that they only hold keys from that range.
+template <class T>
+std::vector<input_set<T>> make_inputs(std::size_t size, std::int32_t min_key, std::int32_t max_key)
+{
+    std::mt19937 generator(0);
+    std::vector<input_set<T>> inputs;
+
+    aligned_vector<T> random(size);
+    std::uniform_int_distribution<std::int32_t> distribution(min_key, max_key);
+    std::generate(random.begin(), random.end(), [&]()
+                  { return static_cast<T>(distribution(generator)); });
+    inputs.push_back({ "random", random });
+
+    aligned_vector<T> sorted = random;
+    std::sort(sorted.begin(), sorted.end());
+    inputs.push_back({ "sorted", sorted });
+
+    aligned_vector<T> reversed(sorted.rbegin(), sorted.rend());
+    inputs.push_back({ "reversed", reversed });
+
+    // Sorted, except for a few swapped pairs.
+    aligned_vector<T> nearly_sorted = sorted;
+    std::uniform_int_distribution<std::size_t> index_distribution(0, size - 1);
+    for (std::size_t i = 0; i < 8; ++i)
+    {
+        std::swap(nearly_sorted[index_distribution(generator)], nearly_sorted[index_distribution(generator)]);
+    }
+    inputs.push_back({ "nearly sorted", nearly_sorted });
+
+    aligned_vector<T> duplicates(size);
+    std::uniform_int_distribution<std::int32_t> small_distribution(0, 15);
+    std::generate(duplicates.begin(), duplicates.end(), [&]()
+                  { return static_cast<T>(small_distribution(generator)); });
+    inputs.push_back({ "duplicates", duplicates });
+
+    return inputs;
+}
+
+template <class T>
+void run_sort(std::string const& type_name, std::size_t size)
+{
+    std::cout << "sort<" << type_name << ">, " << size << " elements" << std::endl;
+    aligned_vector<T> work(size);
+    for (auto const& input : make_inputs<T>(size, -(1 << 30), 1 << 30))
+    {
+        auto reset = [&]()
+        { std::copy(input.values.begin(), input.values.end(), work.begin()); };
+        duration_type scalar = benchmark(reset, [&]()
+                                         { std::sort(work.begin(), work.end()); });
+        duration_type simd = benchmark(reset, [&]()
+                                       { xsimd::sort(work.begin(), work.end()); });
+        print_result(input.name, scalar, simd);
+    }
+}
+
+template <class T>
+void scalar_histogram(aligned_vector<T> const& values, std::vector<std::uint32_t>& counts, T lower, T upper)
+{
+    std::fill(counts.begin(), counts.end(), 0);
+    const std::size_t bins = counts.size();
+    const T scale = static_cast<T>(bins) / (upper - lower);
+    for (T x : values)
+    {
+        if (x >= lower && x < upper)
+        {
+            ++counts[std::min(static_cast<std::size_t>((x - lower) * scale), bins - 1)];
+        }
+    }
+}
+
+template <class T>
+void scalar_histogram(aligned_vector<T> const& values, std::vector<std::uint32_t>& counts, T lower)
+{
+    std::fill(counts.begin(), counts.end(), 0);
+    for (T x : values)
+    {
+        if (x >= lower && static_cast<std::size_t>(x - lower) < counts.size())
+        {
+            ++counts[static_cast<std::size_t>(x - lower)];
+        }
+    }
+}
+
+template <class T>
+void run_histogram(std::string const& type_name, std::size_t size, std::size_t bins, std::size_t calls = 1)
+{
+    std::cout << "histogram<" << type_name << ">, " << size << " elements, " << bins << " bins";
+    if (calls > 1)
+    {
+        std::cout << ", " << calls << " calls";
+    }
+    std::cout << std::endl;
+    std::vector<std::uint32_t> counts(bins);
+    // Keys are drawn from [0, bins) so that every element is counted.
+    for (auto const& input : make_inputs<T>(size, 0, static_cast<std::int32_t>(bins - 1)))
+    {
+        auto nothing = []() {};
+        duration_type scalar, simd;
+        if constexpr (std::is_floating_point<T>::value)
+        {
+            scalar = benchmark(nothing, [&]()
+                               { for (std::size_t i = 0; i < calls; ++i) scalar_histogram(input.values, counts, T(0), static_cast<T>(bins)); });
+            simd = benchmark(nothing, [&]()
+                             { for (std::size_t i = 0; i < calls; ++i) xsimd::histogram(input.values.begin(), input.values.end(), counts.begin(), counts.end(), T(0), static_cast<T>(bins)); });
+        }
+        else
+        {
+            scalar = benchmark(nothing, [&]()
+                               { for (std::size_t i = 0; i < calls; ++i) scalar_histogram(input.values, counts, T(0)); });
+            simd = benchmark(nothing, [&]()
+                             { for (std::size_t i = 0; i < calls; ++i) xsimd::histogram(input.values.begin(), input.values.end(), counts.begin(), counts.end(), T(0)); });
+        }
+        print_result(input.name, scalar, simd);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    std::size_t size = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : std::size_t(1) << 20;
+    std::size_t bins = 256;
+
+    run_sort<float>("float", size);
+    run_sort<std::int32_t>("int32_t", size);
+    run_sort<double>("double", size);
+
+    run_histogram<float>("float", size, bins);
+    run_histogram<std::int32_t>("int32_t", size, bins);
+
+    // Small inputs, where setting up and merging the sub-histograms weighs
+    // as much as counting.
+    std::size_t small_sizes[] = { 1000, 8000 };
+    for (std::size_t small_size : small_sizes)
+    {
+        run_histogram<float>("float", small_size, bins, size / small_size);
+        run_histogram<std::int32_t>("int32_t", small_size, bins, size / small_size);
+    }
+
+    return 0;
+}
@@ -12,7 +12,9 @@
 #ifndef XSIMD_ALGORITHMS_HPP
 #define XSIMD_ALGORITHMS_HPP
 
+#include "xsimd_algorithm/stl/histogram.hpp"
 #include "xsimd_algorithm/stl/reduce.hpp"
+#include "xsimd_algorithm/stl/sort.hpp"
 #include "xsimd_algorithm/stl/transform.hpp"
 
 #endif
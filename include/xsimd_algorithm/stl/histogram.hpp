@@ -0,0 +1,218 @@
+/***************************************************************************
+ * Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+ * Martin Renou                                                             *
+ * Copyright (c) QuantStack                                                 *
+ * Copyright (c) Serge Guelton                                              *
+ *                                                                          *
+ * Distributed under the terms of the BSD 3-Clause License.                 *
+ *                                                                          *
+ * The full license is in the file LICENSE, distributed with this software. *
+ ****************************************************************************/
+
+#ifndef XSIMD_ALGORITHMS_HISTOGRAM_HPP
+#define XSIMD_ALGORITHMS_HISTOGRAM_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "xsimd/xsimd.hpp"
+
+namespace xsimd
+{
+    namespace detail
+    {
+        // Counts the bin indices of [ptr, ptr + size) into lane-private
+        // sub-histograms of ``stride`` counters each, so that duplicate keys
+        // within a batch increment distinct counters.
+        template <class Arch, class T, class BatchBinFunction, class BinFunction>
+        void count_sub_histograms(T const* ptr, std::size_t size, std::uint32_t* counts, std::size_t stride,
+                                  BatchBinFunction& batch_bin_fun, BinFunction& bin_fun)
+        {
+            using batch_type = batch<T, Arch>;
+            using index_type = typename std::decay<decltype(batch_bin_fun(std::declval<batch_type>()))>::type::value_type;
+            constexpr std::size_t simd_size = batch_type::size;
+
+            std::size_t align_begin = xsimd::get_alignment_offset(ptr, size, simd_size);
+            std::size_t align_end = align_begin + ((size - align_begin) & ~(simd_size - 1));
+
+            for (std::size_t i = 0; i < align_begin; ++i)
+            {
+                ++counts[bin_fun(ptr[i])];
+            }
+
+            alignas(Arch::alignment()) index_type indices[simd_size];
+            for (std::size_t i = align_begin; i < align_end; i += simd_size)
+            {
+                batch_type batch = batch_type::load_aligned(ptr + i);
+                batch_bin_fun(batch).store_aligned(indices);
+                for (std::size_t lane = 0; lane < simd_size; ++lane)
+                {
+                    ++counts[lane * stride + static_cast<std::size_t>(indices[lane])];
+                }
+            }
+
+            for (std::size_t i = align_end; i < size; ++i)
+            {
+                ++counts[bin_fun(ptr[i])];
+            }
+        }
+
+        // Number of elements counted before the 32-bit sub-histograms are
+        // flushed to the output, so that no counter can overflow.
+        constexpr std::size_t histogram_chunk_size = (std::size_t(1) << 31) - 1;
+
+        // Counts the bin indices computed by bin_fun, index ``bins``
+        // collecting out-of-range keys.
+        template <class Arch, class Iterator1, class Iterator2, class OutputIterator, class BatchBinFunction, class BinFunction>
+        void histogram_impl(Iterator1 first, Iterator2 last, OutputIterator out_first, std::size_t bins,
+                            BatchBinFunction&& batch_bin_fun, BinFunction&& bin_fun)
+        {
+            using value_type = typename std::decay<decltype(*first)>::type;
+            using count_type = typename std::iterator_traits<OutputIterator>::value_type;
+
+            std::size_t size = static_cast<std::size_t>(std::distance(first, last));
+            constexpr std::size_t simd_size = batch<value_type, Arch>::size;
+            const std::size_t stride = bins + 1;
+
+            std::fill(out_first, out_first + bins, count_type(0));
+
+            // Setting up and merging the sub-histograms would cost more than
+            // counting small inputs directly.
+            if (size < simd_size * stride)
+            {
+                for (; first != last; ++first)
+                {
+                    std::size_t bin = bin_fun(*first);
+                    if (bin < bins)
+                    {
+                        ++out_first[bin];
+                    }
+                }
+                return;
+            }
+
+            const value_type* const ptr_begin = &(*first);
+            std::vector<std::uint32_t> counts(simd_size * stride);
+            for (std::size_t begin = 0; begin < size; begin += histogram_chunk_size)
+            {
+                std::size_t chunk_size = std::min(histogram_chunk_size, size - begin);
+                std::fill(counts.begin(), counts.end(), std::uint32_t(0));
+                count_sub_histograms<Arch>(ptr_begin + begin, chunk_size, counts.data(), stride, batch_bin_fun, bin_fun);
+
+                // merge sub-histograms
+                for (std::size_t bin = 0; bin < bins; ++bin)
+                {
+                    std::size_t count = 0;
+                    for (std::size_t lane = 0; lane < simd_size; ++lane)
+                    {
+                        count += counts[lane * stride + bin];
+                    }
+                    out_first[bin] += static_cast<count_type>(count);
+                }
+            }
+        }
+    }
+
+    /**
+     * Counts the elements of [first, last) falling in each of the
+     * distance(out_first, out_last) bins evenly splitting [lower, upper),
+     * and writes the counts to [out_first, out_last). Elements outside of
+     * [lower, upper) and NaN are not counted. There may be at most 2^30
+     * bins for float values, and 2^62 for double values.
+     */
+    template <class Arch = default_arch, class Iterator1, class Iterator2, class OutputIterator1, class OutputIterator2, class T>
+    void histogram(Iterator1 first, Iterator2 last, OutputIterator1 out_first, OutputIterator2 out_last, T lower, T upper)
+    {
+        using value_type = typename std::decay<decltype(*first)>::type;
+        using batch_type = batch<value_type, Arch>;
+        static_assert(std::is_floating_point<value_type>::value, "bounded histogram requires floating point values");
+
+        std::size_t bins = static_cast<std::size_t>(std::distance(out_first, out_last));
+        if (bins == 0)
+        {
+            return;
+        }
+
+        using index_batch_type = decltype(to_int(std::declval<batch_type>()));
+        using index_type = typename index_batch_type::value_type;
+
+        const value_type vlower = static_cast<value_type>(lower);
+        const value_type vupper = static_cast<value_type>(upper);
+        const value_type scale = static_cast<value_type>(bins) / (vupper - vlower);
+        const index_type last_bin = static_cast<index_type>(bins - 1);
+        const index_type discard_bin = static_cast<index_type>(bins);
+        const value_type max_offset = static_cast<value_type>(std::numeric_limits<index_type>::max() / 2);
+
+        // The bin is clamped to the last one, since rounding may send values
+        // right below upper to index bins. The clamp and the discard index
+        // are applied to integers, as value_type may not represent bins
+        // exactly; the offset is only bounded beforehand so that its
+        // conversion cannot overflow.
+        auto batch_bin_fun = [&](batch_type const& x)
+        {
+            auto in_range = (x >= batch_type(vlower)) & (x < batch_type(vupper));
+            batch_type offset = min((x - batch_type(vlower)) * batch_type(scale), batch_type(max_offset));
+            index_batch_type bin = min(to_int(offset), index_batch_type(last_bin));
+            return select(batch_bool_cast<index_type>(in_range), bin, index_batch_type(discard_bin));
+        };
+        auto bin_fun = [&](value_type x) -> std::size_t
+        {
+            if (!(x >= vlower && x < vupper))
+            {
+                return bins;
+            }
+            return std::min(static_cast<std::size_t>(std::min((x - vlower) * scale, max_offset)), bins - 1);
+        };
+        detail::histogram_impl<Arch>(first, last, out_first, bins, batch_bin_fun, bin_fun);
+    }
+
+    /**
+     * Counts the occurrences of each value of [lower, lower + bins) in the
+     * integral range [first, last), bins being distance(out_first, out_last),
+     * and writes the counts to [out_first, out_last). Other values are not
+     * counted.
+     */
+    template <class Arch = default_arch, class Iterator1, class Iterator2, class OutputIterator1, class OutputIterator2, class T>
+    void histogram(Iterator1 first, Iterator2 last, OutputIterator1 out_first, OutputIterator2 out_last, T lower)
+    {
+        using value_type = typename std::decay<decltype(*first)>::type;
+        using unsigned_type = typename std::make_unsigned<value_type>::type;
+        using batch_type = batch<value_type, Arch>;
+        using unsigned_batch_type = batch<unsigned_type, Arch>;
+        static_assert(std::is_integral<value_type>::value, "unit-width histogram requires integral values");
+
+        std::size_t bins = static_cast<std::size_t>(std::distance(out_first, out_last));
+        if (bins == 0)
+        {
+            return;
+        }
+
+        // Offsets are computed modulo 2^N, so that a single unsigned
+        // comparison discards values below lower as well as above the last
+        // bin.
+        const unsigned_type ulower = static_cast<unsigned_type>(static_cast<value_type>(lower));
+        const unsigned_type ubins = bins < static_cast<std::size_t>(std::numeric_limits<unsigned_type>::max())
+            ? static_cast<unsigned_type>(bins)
+            : std::numeric_limits<unsigned_type>::max();
+
+        auto batch_bin_fun = [&](batch_type const& x)
+        {
+            unsigned_batch_type offset = bitwise_cast<unsigned_type>(x) - unsigned_batch_type(ulower);
+            return select(offset < unsigned_batch_type(ubins), offset, unsigned_batch_type(ubins));
+        };
+        auto bin_fun = [&](value_type x) -> std::size_t
+        {
+            unsigned_type offset = static_cast<unsigned_type>(static_cast<unsigned_type>(x) - ulower);
+            return offset < ubins ? offset : ubins;
+        };
+        detail::histogram_impl<Arch>(first, last, out_first, bins, batch_bin_fun, bin_fun);
+    }
+}
+
+#endif
@@ -0,0 +1,471 @@
+/***************************************************************************
+ * Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+ * Martin Renou                                                             *
+ * Copyright (c) QuantStack                                                 *
+ * Copyright (c) Serge Guelton                                              *
+ *                                                                          *
+ * Distributed under the terms of the BSD 3-Clause License.                 *
+ *                                                                          *
+ * The full license is in the file LICENSE, distributed with this software. *
+ ****************************************************************************/
+
+#ifndef XSIMD_ALGORITHMS_SORT_HPP
+#define XSIMD_ALGORITHMS_SORT_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include "xsimd/xsimd.hpp"
+
+namespace xsimd
+{
+    namespace detail
+    {
+        // Key types handled by the vectorized path on Arch, other arithmetic
+        // types are forwarded to std::sort.
+        template <class T, class Arch>
+        struct is_sortable_key
+            : std::integral_constant<bool,
+                                     (std::is_same<T, float>::value || std::is_same<T, double>::value
+                                      || std::is_same<T, std::int32_t>::value || std::is_same<T, std::uint32_t>::value
+                                      || std::is_same<T, std::int64_t>::value || std::is_same<T, std::uint64_t>::value)
+                                         && types::has_simd_register<T, Arch>::value>
+        {
+        };
+
+        // Number of registers sorted by the in-register network. Ranges up
+        // to sort_block_registers * batch::size elements are not partitioned.
+        constexpr std::size_t sort_block_registers = 16;
+
+        template <class T>
+        constexpr T sort_padding() noexcept
+        {
+            return std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity() : std::numeric_limits<T>::max();
+        }
+
+        // Compare-exchange each lane with lane ``i ^ J``. Lanes whose bit K
+        // is set are sorted in descending order, the others in ascending
+        // order; K == batch::size therefore sorts everything ascending.
+        template <std::size_t J, std::size_t K, class T, class A, std::size_t... Is>
+        XSIMD_INLINE batch<T, A> compare_exchange_lanes(batch<T, A> const& self, std::index_sequence<Is...>) noexcept
+        {
+            using index_type = as_unsigned_integer_t<T>;
+            constexpr batch_constant<index_type, A, static_cast<index_type>(Is ^ J)...> partner_mask {};
+            constexpr batch_bool_constant<T, A, (((Is & J) == 0) != ((Is & K) == 0))...> take_max {};
+            batch<T, A> partner = swizzle(self, partner_mask);
+            return select(take_max, max(self, partner), min(self, partner));
+        }
+
+        template <class T, class A, std::size_t... Is>
+        XSIMD_INLINE batch<T, A> reverse_lanes(batch<T, A> const& self, std::index_sequence<Is...>) noexcept
+        {
+            using index_type = as_unsigned_integer_t<T>;
+            constexpr batch_constant<index_type, A, static_cast<index_type>(sizeof...(Is) - 1 - Is)...> mask {};
+            return swizzle(self, mask);
+        }
+
+        template <class T, class A>
+        XSIMD_INLINE batch<T, A> reverse_lanes(batch<T, A> const& self) noexcept
+        {
+            return reverse_lanes(self, std::make_index_sequence<batch<T, A>::size>());
+        }
+
+        // Bitonic sorting network over the lanes of a single register.
+        template <std::size_t K, std::size_t J, class T, class A>
+        XSIMD_INLINE batch<T, A> sort_lanes(batch<T, A> const& self) noexcept
+        {
+            constexpr std::size_t size = batch<T, A>::size;
+            batch<T, A> res = compare_exchange_lanes<J, K>(self, std::make_index_sequence<size>());
+            if constexpr (J > 1)
+                return sort_lanes<K, J / 2>(res);
+            else if constexpr (K < size)
+                return sort_lanes<2 * K, K>(res);
+            else
+                return res;
+        }
+
+        template <class T, class A>
+        XSIMD_INLINE batch<T, A> sort_lanes(batch<T, A> const& self) noexcept
+        {
+            if constexpr (batch<T, A>::size > 1)
+                return sort_lanes<2, 1>(self);
+            else
+                return self;
+        }
+
+        // Bitonic merge of the lanes of a single register holding a bitonic
+        // sequence.
+        template <std::size_t J, class T, class A>
+        XSIMD_INLINE batch<T, A> merge_lanes(batch<T, A> const& self) noexcept
+        {
+            constexpr std::size_t size = batch<T, A>::size;
+            batch<T, A> res = compare_exchange_lanes<J, size>(self, std::make_index_sequence<size>());
+            if constexpr (J > 1)
+                return merge_lanes<J / 2>(res);
+            else
+                return res;
+        }
+
+        template <class T, class A>
+        XSIMD_INLINE batch<T, A> merge_lanes(batch<T, A> const& self) noexcept
+        {
+            if constexpr (batch<T, A>::size > 1)
+                return merge_lanes<batch<T, A>::size / 2>(self);
+            else
+                return self;
+        }
+
+        // Exchange lo and hi where hi < lo. min and max may return the same
+        // operand when both compare equal, which would turn a pair of -0.0
+        // and +0.0 into two copies of one of them, hence the selects for
+        // floating point values.
+        template <class T, class A>
+        XSIMD_INLINE void compare_exchange_registers(batch<T, A>& lo, batch<T, A>& hi) noexcept
+        {
+            if constexpr (std::is_floating_point<T>::value)
+            {
+                auto swap = hi < lo;
+                batch<T, A> res = select(swap, hi, lo);
+                hi = select(swap, lo, hi);
+                lo = res;
+            }
+            else
+            {
+                batch<T, A> res = min(lo, hi);
+                hi = max(lo, hi);
+                lo = res;
+            }
+        }
+
+        // Calls f with std::integral_constant<std::size_t, I> for each I in
+        // [0, N), so that register indices are compile-time constants.
+        template <std::size_t N, class F>
+        XSIMD_INLINE void static_for(F&& f) noexcept
+        {
+            [&]<std::size_t... Is>(std::index_sequence<Is...>)
+            {
+                (f(std::integral_constant<std::size_t, Is>()), ...);
+            }(std::make_index_sequence<N>());
+        }
+
+        // Sort the bitonic sequence held by registers [Offset, Offset + Count).
+        template <std::size_t Offset, std::size_t Count, class T, class A, std::size_t N>
+        XSIMD_INLINE void merge_registers(std::array<batch<T, A>, N>& regs) noexcept
+        {
+            if constexpr (Count == 1)
+            {
+                std::get<Offset>(regs) = merge_lanes(std::get<Offset>(regs));
+            }
+            else
+            {
+                constexpr std::size_t half = Count / 2;
+                static_for<half>([&](auto i)
+                                 {
+                    compare_exchange_registers(std::get<Offset + i>(regs), std::get<Offset + half + i>(regs)); });
+                merge_registers<Offset, half>(regs);
+                merge_registers<Offset + half, half>(regs);
+            }
+        }
+
+        // Sort registers [Offset, Offset + Count), Count being a power of
+        // two, so that their concatenation is in ascending order.
+        template <std::size_t Offset, std::size_t Count, class T, class A, std::size_t N>
+        XSIMD_INLINE void sort_registers(std::array<batch<T, A>, N>& regs) noexcept
+        {
+            if constexpr (Count == 1)
+            {
+                std::get<Offset>(regs) = sort_lanes(std::get<Offset>(regs));
+            }
+            else
+            {
+                constexpr std::size_t half = Count / 2;
+                sort_registers<Offset, half>(regs);
+                sort_registers<Offset + half, half>(regs);
+
+                // Compare the first half with the reversed second one: both
+                // halves become bitonic and every element of the lower half
+                // is less than every element of the upper half. The upper
+                // half is stored reversed, which keeps it bitonic.
+                static_for<half>([&](auto i)
+                                 {
+                    batch<T, A> lo = std::get<Offset + i>(regs);
+                    batch<T, A> hi = reverse_lanes(std::get<Offset + Count - 1 - i>(regs));
+                    compare_exchange_registers(lo, hi);
+                    std::get<Offset + i>(regs) = lo;
+                    std::get<Offset + Count - 1 - i>(regs) = reverse_lanes(hi); });
+                merge_registers<Offset, half>(regs);
+                merge_registers<Offset + half, half>(regs);
+            }
+        }
+
+        // Sort the size <= Count * batch::size elements of [first, last)
+        // with a bitonic network over Count registers, padding the unused
+        // lanes with the largest value of T. count is the number of
+        // registers actually needed, rounded up to a power of two.
+        template <class A, std::size_t Count, class T>
+        void sort_block(T* first, T* last, std::size_t count) noexcept
+        {
+            if constexpr (Count < sort_block_registers)
+            {
+                if (count > Count)
+                {
+                    sort_block<A, 2 * Count>(first, last, count);
+                    return;
+                }
+            }
+
+            using batch_type = batch<T, A>;
+            constexpr std::size_t simd_size = batch_type::size;
+
+            std::size_t size = static_cast<std::size_t>(last - first);
+            std::size_t full_count = size / simd_size;
+            std::size_t tail_size = size - full_count * simd_size;
+
+            alignas(A::alignment()) T tail[simd_size];
+            if (tail_size != 0)
+            {
+                std::fill(tail + tail_size, tail + simd_size, sort_padding<T>());
+                std::copy(first + full_count * simd_size, last, tail);
+            }
+
+            std::array<batch_type, Count> regs;
+            static_for<Count>([&](auto i)
+                              {
+                if (i < full_count)
+                    std::get<i>(regs) = batch_type::load_unaligned(first + i * simd_size);
+                else if (i == full_count && tail_size != 0)
+                    std::get<i>(regs) = batch_type::load_aligned(tail);
+                else
+                    std::get<i>(regs) = batch_type(sort_padding<T>()); });
+
+            sort_registers<0, Count>(regs);
+
+            static_for<Count>([&](auto i)
+                              {
+                if (i < full_count)
+                    std::get<i>(regs).store_unaligned(first + i * simd_size);
+                else if (i == full_count && tail_size != 0)
+                    std::get<i>(regs).store_aligned(tail); });
+            if (tail_size != 0)
+            {
+                std::copy(tail, tail + tail_size, first + full_count * simd_size);
+            }
+        }
+
+        template <class A, class T>
+        void sort_block(T* first, T* last) noexcept
+        {
+            std::size_t size = static_cast<std::size_t>(last - first);
+            std::size_t simd_size = batch<T, A>::size;
+            sort_block<A, 1>(first, last, std::bit_ceil((size + simd_size - 1) / simd_size));
+        }
+
+        template <bool OrEqual, class T, class A>
+        XSIMD_INLINE batch_bool<T, A> goes_left(batch<T, A> const& value, batch<T, A> const& pivot) noexcept
+        {
+            if constexpr (OrEqual)
+                return value <= pivot;
+            else
+                return value < pivot;
+        }
+
+        template <bool OrEqual, class T, class A>
+        XSIMD_INLINE batch_bool<T, A> goes_right(batch<T, A> const& value, batch<T, A> const& pivot) noexcept
+        {
+            if constexpr (OrEqual)
+                return value > pivot;
+            else
+                return value >= pivot;
+        }
+
+        template <bool OrEqual, class T>
+        XSIMD_INLINE bool goes_left(T value, T pivot) noexcept
+        {
+            if constexpr (OrEqual)
+                return value <= pivot;
+            else
+                return value < pivot;
+        }
+
+        // Branchless move of a single element to the free slot at the
+        // left or right end of the partition.
+        template <class T>
+        XSIMD_INLINE void move_partition(T value, bool left, T*& write_left, T*& write_right) noexcept
+        {
+            T* dst = left ? write_left : write_right - 1;
+            *dst = value;
+            write_left += left;
+            write_right -= !left;
+        }
+
+        // In-place partition of [first, last) with respect to pivot. The
+        // first and last batches are buffered so that each batch read opens
+        // at least batch::size free slots at both ends of the partition.
+        // The elements of the batch going left are compressed to the lower
+        // lanes and stored at the left end; the ones going right are
+        // compressed to the upper lanes, through a lane reversal, and stored
+        // at the right end. The remaining lanes of both stores land in free
+        // slots. Requires last - first >= 2 * batch::size.
+        template <class A, bool OrEqual, class T>
+        T* partition(T* first, T* last, T pivot) noexcept
+        {
+            using batch_type = batch<T, A>;
+            constexpr std::size_t simd_size = batch_type::size;
+
+            alignas(A::alignment()) T buffer[2 * simd_size];
+            std::copy(first, first + simd_size, buffer);
+            std::copy(last - simd_size, last, buffer + simd_size);
+
+            T* read_left = first + simd_size;
+            T* read_right = last - simd_size;
+            T* write_left = first;
+            T* write_right = last;
+
+            const batch_type batch_pivot(pivot);
+            while (static_cast<std::size_t>(read_right - read_left) >= simd_size)
+            {
+                // Read from the side with the least free room.
+                batch_type batch;
+                if (read_left - write_left <= write_right - read_right)
+                {
+                    batch = batch_type::load_unaligned(read_left);
+                    read_left += simd_size;
+                }
+                else
+                {
+                    read_right -= simd_size;
+                    batch = batch_type::load_unaligned(read_right);
+                }
+
+                auto left_mask = goes_left<OrEqual>(batch, batch_pivot);
+                std::size_t left_count = static_cast<std::size_t>(std::popcount(left_mask.mask()));
+                batch_type reversed = reverse_lanes(batch);
+
+                compress(batch, left_mask).store_unaligned(write_left);
+                reverse_lanes(compress(reversed, goes_right<OrEqual>(reversed, batch_pivot))).store_unaligned(write_right - simd_size);
+                write_left += left_count;
+                write_right -= simd_size - left_count;
+            }
+
+            while (read_left < read_right)
+            {
+                T value = (read_left - write_left <= write_right - read_right) ? *read_left++ : *--read_right;
+                move_partition(value, goes_left<OrEqual>(value, pivot), write_left, write_right);
+            }
+
+            for (std::size_t i = 0; i < 2 * simd_size; ++i)
+            {
+                move_partition(buffer[i], goes_left<OrEqual>(buffer[i], pivot), write_left, write_right);
+            }
+            return write_left;
+        }
+
+        // Number of elements sampled to pick a pivot.
+        constexpr std::size_t pivot_samples = 15;
+
+        // Median of pivot_samples elements spread evenly over [first, last).
+        // A median of the ends and middle of the range is easily defeated
+        // by structured input, such as the subranges left by partition.
+        template <class T>
+        T select_pivot(T const* first, T const* last) noexcept
+        {
+            std::size_t step = static_cast<std::size_t>(last - first) / pivot_samples;
+            T samples[pivot_samples];
+            for (std::size_t i = 0; i < pivot_samples; ++i)
+            {
+                samples[i] = first[i * step + step / 2];
+            }
+            std::nth_element(samples, samples + pivot_samples / 2, samples + pivot_samples);
+            return samples[pivot_samples / 2];
+        }
+
+        template <class A, class T>
+        void sort_impl(T* first, T* last, std::size_t depth_limit) noexcept
+        {
+            constexpr std::size_t block_size = sort_block_registers * batch<T, A>::size;
+
+            while (static_cast<std::size_t>(last - first) > block_size)
+            {
+                if (depth_limit == 0)
+                {
+                    std::make_heap(first, last);
+                    std::sort_heap(first, last);
+                    return;
+                }
+                --depth_limit;
+
+                T pivot = select_pivot(first, last);
+                T* middle = partition<A, false>(first, last, pivot);
+                if (middle == first)
+                {
+                    // pivot is the minimum of the range: move every element
+                    // equal to it to the front, where they are sorted.
+                    first = partition<A, true>(first, last, pivot);
+                    continue;
+                }
+
+                // Recurse into the smaller part to bound the stack depth.
+                if (middle - first < last - middle)
+                {
+                    sort_impl<A>(first, middle, depth_limit);
+                    first = middle;
+                }
+                else
+                {
+                    sort_impl<A>(middle, last, depth_limit);
+                    last = middle;
+                }
+            }
+            sort_block<A>(first, last);
+        }
+    }
+
+    /**
+     * Sorts the contiguous range [first, last) in ascending order.
+     *
+     * Ranges of float, double and 32 or 64-bit integers are sorted with a
+     * quicksort whose partition step compares a whole batch against the
+     * pivot, small partitions being sorted by in-register bitonic networks.
+     * Other arithmetic types, and types Arch has no register for, are
+     * sorted with std::sort. Floating-point
+     * ranges must not contain NaN. The sort is not stable.
+     */
+    template <class Arch = default_arch, class Iterator1, class Iterator2>
+    void sort(Iterator1 first, Iterator2 last) noexcept
+    {
+        using value_type = typename std::decay<decltype(*first)>::type;
+        static_assert(std::is_arithmetic<value_type>::value, "xsimd::sort requires arithmetic values");
+
+        std::size_t size = static_cast<std::size_t>(std::distance(first, last));
+        if (size < 2)
+        {
+            return;
+        }
+
+        value_type* ptr_begin = &(*first);
+        if constexpr (detail::is_sortable_key<value_type, Arch>::value)
+        {
+            // Partitioning does not take advantage of presorted input, while
+            // detecting it usually stops after a few elements.
+            if (std::is_sorted(ptr_begin, ptr_begin + size))
+            {
+                return;
+            }
+            std::size_t depth_limit = 2 * static_cast<std::size_t>(std::bit_width(size));
+            detail::sort_impl<Arch>(ptr_begin, ptr_begin + size, depth_limit);
+        }
+        else
+        {
+            std::sort(ptr_begin, ptr_begin + size);
+        }
+    }
+}
+
+#endif
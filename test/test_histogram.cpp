@@ -0,0 +1,102 @@
+/***************************************************************************
+ * Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+ * Martin Renou                                                             *
+ * Copyright (c) QuantStack                                                 *
+ * Copyright (c) Serge Guelton                                              *
+ *                                                                          *
+ * Distributed under the terms of the BSD 3-Clause License.                 *
+ *                                                                          *
+ * The full license is in the file LICENSE, distributed with this software. *
+ ****************************************************************************/
+
+#include "xsimd_algorithm/stl/histogram.hpp"
+
+#ifndef XSIMD_NO_SUPPORTED_ARCHITECTURE
+
+#include "doctest/doctest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#if XSIMD_WITH_NEON && !XSIMD_WITH_NEON64
+#define HISTOGRAM_FLOAT_TYPES float
+#define HISTOGRAM_INTEGER_TYPES int32_t, uint32_t
+#else
+#define HISTOGRAM_FLOAT_TYPES float, double
+#define HISTOGRAM_INTEGER_TYPES int32_t, uint32_t, int64_t, uint64_t
+#endif
+
+TEST_CASE_TEMPLATE("histogram test - floating point", T, HISTOGRAM_FLOAT_TYPES)
+{
+    std::mt19937 generator(0);
+    std::uniform_real_distribution<T> distribution(T(-1), T(11));
+    std::vector<T, xsimd::aligned_allocator<T>> values(1001);
+    std::generate(values.begin(), values.end(), [&]()
+                  { return distribution(generator); });
+    values[3] = T(10);
+    values[4] = std::nextafter(T(10), T(0));
+    values[5] = std::numeric_limits<T>::quiet_NaN();
+    values[6] = std::numeric_limits<T>::infinity();
+
+    for (std::size_t offset = 0; offset < 3; ++offset)
+    {
+        std::vector<std::size_t> expected(7, 0);
+        for (std::size_t i = offset; i < values.size(); ++i)
+        {
+            T x = values[i];
+            if (x >= T(0) && x < T(10))
+            {
+                ++expected[std::min(static_cast<std::size_t>(x * T(0.7)), std::size_t(6))];
+            }
+        }
+
+        std::vector<std::size_t> res(7);
+        xsimd::histogram(values.begin() + offset, values.end(), res.begin(), res.end(), T(0), T(10));
+        CHECK(res == expected);
+    }
+
+    std::vector<std::size_t> res(7, 42);
+    xsimd::histogram(values.begin(), values.begin() + 1, res.begin(), res.end(), T(-1), T(11));
+    CHECK(std::accumulate(res.begin(), res.end(), std::size_t(0)) == 1);
+}
+
+TEST_CASE_TEMPLATE("histogram test - integral", T, HISTOGRAM_INTEGER_TYPES)
+{
+    std::mt19937 generator(0);
+    std::uniform_int_distribution<int> distribution(0, 300);
+    // Small inputs are counted without sub-histograms.
+    for (std::size_t size : { 100, 5000 })
+    {
+        std::vector<T> values(size);
+        std::generate(values.begin(), values.end(), [&]()
+                      { return static_cast<T>(distribution(generator)); });
+        values[7] = std::numeric_limits<T>::min();
+        values[8] = std::numeric_limits<T>::max();
+
+        std::vector<std::uint32_t> expected(256, 0);
+        for (T x : values)
+        {
+            if (x >= T(20) && x < T(276))
+            {
+                ++expected[static_cast<std::size_t>(x - T(20))];
+            }
+        }
+
+        std::vector<std::uint32_t> res(256);
+        xsimd::histogram(values.begin(), values.end(), res.begin(), res.end(), T(20));
+        CHECK(res == expected);
+    }
+
+    std::vector<std::uint32_t> res(256);
+    std::vector<T> duplicates(5000, T(21));
+    xsimd::histogram(duplicates.begin(), duplicates.end(), res.begin(), res.end(), T(20));
+    CHECK(res[1] == 5000);
+    CHECK(std::accumulate(res.begin(), res.end(), std::uint32_t(0)) == 5000);
+}
+
+#endif
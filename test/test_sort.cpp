@@ -0,0 +1,192 @@
+/***************************************************************************
+ * Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+ * Martin Renou                                                             *
+ * Copyright (c) QuantStack                                                 *
+ * Copyright (c) Serge Guelton                                              *
+ *                                                                          *
+ * Distributed under the terms of the BSD 3-Clause License.                 *
+ *                                                                          *
+ * The full license is in the file LICENSE, distributed with this software. *
+ ****************************************************************************/
+
+#include "xsimd_algorithm/stl/sort.hpp"
+
+#ifndef XSIMD_NO_SUPPORTED_ARCHITECTURE
+
+#include "doctest/doctest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#define SORT_TYPES float, double, int32_t, uint32_t, int64_t, uint64_t
+
+template <typename Type>
+struct sort_test
+{
+    using vector = std::vector<Type>;
+    using aligned_vector = std::vector<Type, xsimd::aligned_allocator<Type>>;
+
+    static constexpr std::size_t sizes[] = { 0, 1, 2, 3, 15, 16, 17, 93, 255, 256, 257, 1000, 4099, 65537 };
+
+    template <class V>
+    void check_sort(V values) const
+    {
+        V expected = values;
+        std::sort(expected.begin(), expected.end());
+
+        xsimd::sort(values.begin(), values.end());
+        CHECK(values == expected);
+    }
+
+    void test_random() const
+    {
+        std::mt19937 generator(0);
+        std::uniform_int_distribution<int> distribution(-1000000, 1000000);
+        for (std::size_t size : sizes)
+        {
+            vector values(size);
+            std::generate(values.begin(), values.end(), [&]()
+                          { return static_cast<Type>(distribution(generator)); });
+            check_sort(values);
+            check_sort(aligned_vector(values.begin(), values.end()));
+        }
+    }
+
+    void test_sorted() const
+    {
+        for (std::size_t size : sizes)
+        {
+            vector values(size);
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                values[i] = static_cast<Type>(i);
+            }
+            check_sort(values);
+            std::reverse(values.begin(), values.end());
+            check_sort(values);
+        }
+    }
+
+    void test_nearly_sorted() const
+    {
+        std::mt19937 generator(0);
+        for (std::size_t size : sizes)
+        {
+            if (size < 2)
+            {
+                continue;
+            }
+            vector values(size);
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                values[i] = static_cast<Type>(i);
+            }
+            std::uniform_int_distribution<std::size_t> distribution(0, size - 1);
+            for (std::size_t i = 0; i < 4; ++i)
+            {
+                std::swap(values[distribution(generator)], values[distribution(generator)]);
+            }
+            check_sort(values);
+        }
+    }
+
+    void test_organ_pipe() const
+    {
+        for (std::size_t size : sizes)
+        {
+            vector values(size);
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                values[i] = static_cast<Type>(i < size / 2 ? i : size - i);
+            }
+            check_sort(values);
+        }
+    }
+
+    void test_duplicates() const
+    {
+        std::mt19937 generator(0);
+        std::uniform_int_distribution<int> distribution(0, 3);
+        for (std::size_t size : sizes)
+        {
+            vector values(size);
+            std::generate(values.begin(), values.end(), [&]()
+                          { return static_cast<Type>(distribution(generator)); });
+            check_sort(values);
+            check_sort(vector(size, Type(42)));
+        }
+    }
+
+    void test_unaligned() const
+    {
+        std::mt19937 generator(0);
+        std::uniform_int_distribution<int> distribution(0, 1000);
+        aligned_vector values(1001);
+        std::generate(values.begin(), values.end(), [&]()
+                      { return static_cast<Type>(distribution(generator)); });
+        aligned_vector expected = values;
+        std::sort(std::next(expected.begin()), std::prev(expected.end()));
+
+        xsimd::sort(std::next(values.begin()), std::prev(values.end()));
+        CHECK(values == expected);
+    }
+};
+
+TEST_CASE_TEMPLATE("sort test", T, SORT_TYPES)
+{
+    sort_test<T> Test;
+
+    SUBCASE("random") { Test.test_random(); }
+    SUBCASE("sorted") { Test.test_sorted(); }
+    SUBCASE("nearly sorted") { Test.test_nearly_sorted(); }
+    SUBCASE("organ pipe") { Test.test_organ_pipe(); }
+    SUBCASE("duplicates") { Test.test_duplicates(); }
+    SUBCASE("unaligned") { Test.test_unaligned(); }
+}
+
+template <class T>
+std::size_t count_negative(std::vector<T> const& values)
+{
+    return static_cast<std::size_t>(std::count_if(values.begin(), values.end(), [](T x)
+                                                  { return std::signbit(x); }));
+}
+
+TEST_CASE("sort test - extreme values")
+{
+    std::vector<float> values = { 3.f, -std::numeric_limits<float>::infinity(), 0.f, -0.f,
+                                  std::numeric_limits<float>::infinity(), std::numeric_limits<float>::lowest(),
+                                  std::numeric_limits<float>::max(), 1.f };
+    std::vector<float> expected = values;
+    std::sort(expected.begin(), expected.end());
+
+    xsimd::sort(values.begin(), values.end());
+    CHECK(std::is_sorted(values.begin(), values.end()));
+    CHECK(std::is_permutation(values.begin(), values.end(), expected.begin()));
+    CHECK(count_negative(values) == count_negative(expected));
+}
+
+TEST_CASE_TEMPLATE("sort test - signed zeros", T, float, double)
+{
+    // -0 and +0 compare equal, so they are told apart by their sign bit.
+    std::mt19937 generator(0);
+    std::uniform_int_distribution<int> distribution(0, 3);
+    for (std::size_t size : { 9, 64, 93, 1000, 4099 })
+    {
+        std::vector<T> values(size);
+        std::generate(values.begin(), values.end(), [&]()
+                      {
+            int r = distribution(generator);
+            return r == 0 ? T(-0.) : r == 1 ? T(0.) : static_cast<T>(r - 2); });
+        std::size_t negative = count_negative(values);
+
+        xsimd::sort(values.begin(), values.end());
+        CHECK(std::is_sorted(values.begin(), values.end()));
+        CHECK(count_negative(values) == negative);
+    }
+}
+
+#endif